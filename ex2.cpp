@@ -1,102 +1,9 @@
 #include <iostream>
-#include <vector>
 #include <string>
-#include <sstream>
-#include <iomanip>
 
-using namespace std;
-
-class CellularAutomaton {
-private:
-    vector<int> state;
-    int rule;
-
-    int get_next_cell(int left, int center, int right) {
-        int index = (left << 2) | (center << 1) | right;
-        return (rule >> index) & 1;
-    }
-
-public:
-    CellularAutomaton(int r) : rule(r) {}
-
-    void init_state(const vector<int>& initial) {
-        state = initial;
-    }
+#include "blockchain/hash.h"
 
-    void evolve() {
-        int n = state.size();
-        vector<int> new_state(n);
-        
-        for (int i = 0; i < n; i++) {
-            int left = (i == 0) ? 0 : state[i - 1];
-            int center = state[i];
-            int right = (i == n - 1) ? 0 : state[i + 1];
-            
-            new_state[i] = get_next_cell(left, center, right);
-        }
-        
-        state = new_state;
-    }
-
-    void print() {
-        for (int cell : state) {
-            cout << (cell ? "█" : " ");
-        }
-        cout << endl;
-    }
-
-    vector<int> get_state() {
-        return state;
-    }
-};
-
-string ac_hash(const string& input, uint32_t rule, size_t steps) {
-    vector<int> bits;
-    
-    for (char c : input) {
-        for (int i = 7; i >= 0; i--) {
-            bits.push_back((c >> i) & 1);
-        }
-    }
-    
-    while (bits.size() < 256) {
-        bits.push_back(0);
-    }
-    
-    if (bits.size() > 512) {
-        vector<int> folded(512, 0);
-        for (size_t i = 0; i < bits.size(); i++) {
-            folded[i % 512] ^= bits[i];
-        }
-        bits = folded;
-    }
-    
-    CellularAutomaton ca(rule);
-    ca.init_state(bits);
-    
-    for (size_t i = 0; i < steps; i++) {
-        ca.evolve();
-    }
-    
-    vector<int> final_state = ca.get_state();
-    vector<int> hash_bits(256);
-    
-    for (int i = 0; i < 256; i++) {
-        hash_bits[i] = final_state[i % final_state.size()] ^ 
-                       final_state[(i * 3) % final_state.size()];
-    }
-    
-    stringstream ss;
-    for (int i = 0; i < 256; i += 8) {
-        int byte = 0;
-        for (int j = 0; j < 8; j++) {
-            byte = (byte << 1) | hash_bits[i + j];
-        }
-        ss << hex << setw(2) << setfill('0') << byte;
-    }
-    
-    return ss.str();
-}
+using namespace std;
 
 int main() {
     string input1 = "Hello, World!";
@@ -0,0 +1,790 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <ctime>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <cerrno>
+#include <csignal>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#include "blockchain/blockchain.h"
+#include "blockchain/pool.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// ---------------------------------------------------------------------------
+// Socket I/O for the protocol in blockchain/pool.h
+// ---------------------------------------------------------------------------
+
+bool send_all(int fd, const uint8_t* buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = send(fd, buf, len, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        buf += n;
+        len -= n;
+    }
+    return true;
+}
+
+bool recv_all(int fd, uint8_t* buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = recv(fd, buf, len, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        buf += n;
+        len -= n;
+    }
+    return true;
+}
+
+// Blocking helpers, used by workers which only ever talk to one coordinator.
+bool send_message(int fd, uint8_t type, const MessageWriter& w) {
+    vector<uint8_t> frame = encode_frame(type, w);
+    return send_all(fd, frame.data(), frame.size());
+}
+
+bool recv_message(int fd, Message& msg) {
+    uint8_t header[HEADER_SIZE];
+    if (!recv_all(fd, header, HEADER_SIZE)) {
+        return false;
+    }
+    uint32_t len = frame_length(header);
+    if (len > MAX_PAYLOAD) {
+        return false;
+    }
+    msg.type = header[0];
+    msg.payload.resize(len);
+    return len == 0 || recv_all(fd, msg.payload.data(), len);
+}
+
+bool set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+// ---------------------------------------------------------------------------
+// Endpoints: "unix:/path/to.sock" or "tcp:host:port" (the "tcp:" prefix is
+// optional). The host is a name or an IPv4/IPv6 address; IPv6 addresses
+// go in brackets, e.g. "tcp:[::1]:5555".
+// ---------------------------------------------------------------------------
+
+struct Endpoint {
+    bool is_unix;
+    string path;
+    string host;
+    int port;
+};
+
+Endpoint parse_endpoint(const string& spec) {
+    Endpoint ep;
+    ep.is_unix = false;
+    ep.port = 0;
+
+    if (spec.rfind("unix:", 0) == 0) {
+        ep.is_unix = true;
+        ep.path = spec.substr(5);
+        return ep;
+    }
+
+    string rest = spec.rfind("tcp:", 0) == 0 ? spec.substr(4) : spec;
+    size_t colon = rest.rfind(':');
+    if (colon == string::npos) {
+        throw runtime_error("bad endpoint: " + spec);
+    }
+    ep.host = rest.substr(0, colon);
+    if (ep.host.size() >= 2 && ep.host.front() == '[' && ep.host.back() == ']') {
+        ep.host = ep.host.substr(1, ep.host.size() - 2);
+    }
+    ep.port = stoi(rest.substr(colon + 1));
+    return ep;
+}
+
+string format_endpoint(const Endpoint& ep) {
+    if (ep.is_unix) {
+        return "unix:" + ep.path;
+    }
+    string host = ep.host.find(':') != string::npos ? "[" + ep.host + "]" : ep.host;
+    return "tcp:" + host + ":" + to_string(ep.port);
+}
+
+// Resolves a TCP endpoint with getaddrinfo. The caller frees the list.
+addrinfo* resolve(const Endpoint& ep, bool passive) {
+    addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = passive ? AI_PASSIVE : 0;
+    addrinfo* res = nullptr;
+    int rc = getaddrinfo(ep.host.empty() ? nullptr : ep.host.c_str(), to_string(ep.port).c_str(),
+                         &hints, &res);
+    if (rc != 0) {
+        throw runtime_error("cannot resolve " + ep.host + ": " + gai_strerror(rc));
+    }
+    return res;
+}
+
+int listen_on(Endpoint& ep) {
+    int fd;
+    if (ep.is_unix) {
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr = {};
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, ep.path.c_str(), sizeof(addr.sun_path) - 1);
+        // Replace a stale socket from an earlier run, but never anything else.
+        struct stat st;
+        if (lstat(ep.path.c_str(), &st) == 0) {
+            if (!S_ISSOCK(st.st_mode)) {
+                throw runtime_error("cannot bind " + ep.path + ": exists and is not a socket");
+            }
+            unlink(ep.path.c_str());
+        }
+        if (fd < 0 || ::bind(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+            throw runtime_error("cannot bind " + ep.path + ": " + strerror(errno));
+        }
+    } else {
+        addrinfo* res = resolve(ep, true);
+        fd = -1;
+        int err = 0;
+        for (addrinfo* ai = res; ai && fd < 0; ai = ai->ai_next) {
+            fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+            if (fd < 0) {
+                err = errno;
+                continue;
+            }
+            int one = 1;
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+            if (::bind(fd, ai->ai_addr, ai->ai_addrlen) < 0) {
+                err = errno;
+                close(fd);
+                fd = -1;
+            }
+        }
+        freeaddrinfo(res);
+        if (fd < 0) {
+            throw runtime_error("cannot bind port " + to_string(ep.port) + ": " + strerror(err));
+        }
+        // Port 0 asks the kernel for a free port; report the real one.
+        sockaddr_storage addr = {};
+        socklen_t len = sizeof(addr);
+        getsockname(fd, (sockaddr*)&addr, &len);
+        ep.port = addr.ss_family == AF_INET6 ? ntohs(((sockaddr_in6*)&addr)->sin6_port)
+                                             : ntohs(((sockaddr_in*)&addr)->sin_port);
+    }
+    if (listen(fd, 64) < 0) {
+        throw runtime_error(string("listen failed: ") + strerror(errno));
+    }
+    return fd;
+}
+
+// Closes a listener from listen_on() and removes its socket file.
+void close_listener(int fd, const Endpoint& ep) {
+    close(fd);
+    if (ep.is_unix) {
+        unlink(ep.path.c_str());
+    }
+}
+
+int connect_to(const Endpoint& ep) {
+    int fd;
+    if (ep.is_unix) {
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr = {};
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, ep.path.c_str(), sizeof(addr.sun_path) - 1);
+        if (fd < 0 || connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+            throw runtime_error("cannot connect to " + ep.path + ": " + strerror(errno));
+        }
+    } else {
+        addrinfo* res = resolve(ep, false);
+        fd = -1;
+        int err = 0;
+        for (addrinfo* ai = res; ai && fd < 0; ai = ai->ai_next) {
+            fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+            if (fd < 0) {
+                err = errno;
+                continue;
+            }
+            if (connect(fd, ai->ai_addr, ai->ai_addrlen) < 0) {
+                err = errno;
+                close(fd);
+                fd = -1;
+            }
+        }
+        freeaddrinfo(res);
+        if (fd < 0) {
+            throw runtime_error("cannot connect to " + ep.host + ": " + strerror(err));
+        }
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    return fd;
+}
+
+// ---------------------------------------------------------------------------
+// Coordinator
+// ---------------------------------------------------------------------------
+
+struct PoolConfig {
+    int difficulty;
+    int share_difficulty;
+    HashMode mode;
+    int num_blocks;
+    uint32_t range_size;
+};
+
+// A connection that has unsent output or a partial frame and makes no
+// progress for this long is dropped, so one stalled worker cannot hold up
+// the pool.
+const auto IO_TIMEOUT = seconds(10);
+const size_t MAX_OUTBUF = 1 << 20;
+
+struct WorkerStats {
+    int fd;
+    string name;
+    uint64_t shares_accepted;
+    uint64_t shares_rejected;
+    uint64_t blocks_found;
+    uint64_t hashes_reported;
+    steady_clock::time_point connected_at;
+    NonceRanges ranges;  // for the current job
+
+    // The coordinator never blocks on a socket: frames are assembled in
+    // `inbuf` and queued replies drain from `outbuf` when poll allows.
+    vector<uint8_t> inbuf;
+    vector<uint8_t> outbuf;
+    steady_clock::time_point last_progress;
+    bool dead;
+    bool write_closed;
+
+    WorkerStats(int f)
+        : fd(f), shares_accepted(0), shares_rejected(0), blocks_found(0), hashes_reported(0),
+          connected_at(steady_clock::now()), last_progress(steady_clock::now()),
+          dead(false), write_closed(false) {}
+};
+
+class Coordinator {
+private:
+    PoolConfig config;
+    Blockchain blockchain;
+    int listen_fd;
+
+    ShareValidator shares;
+
+    vector<WorkerStats> workers;
+    vector<WorkerStats> finished;
+
+    void new_template() {
+        int idx = blockchain.size();
+        stringstream ss;
+        ss << "Transaction " << idx;
+        Block block(idx, ss.str(), "");
+        blockchain.prepare_block(block);
+        shares.new_job(block);
+        for (WorkerStats& w : workers) {
+            w.ranges.clear();
+        }
+    }
+
+    // Sends as much of the output queue as the socket accepts right now.
+    void flush(WorkerStats& w) {
+        while (!w.outbuf.empty() && !w.dead) {
+            ssize_t n = send(w.fd, w.outbuf.data(), w.outbuf.size(), 0);
+            if (n > 0) {
+                w.outbuf.erase(w.outbuf.begin(), w.outbuf.begin() + n);
+                w.last_progress = steady_clock::now();
+            } else if (n < 0 && errno == EINTR) {
+                continue;
+            } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            } else {
+                w.dead = true;
+            }
+        }
+    }
+
+    void queue_message(WorkerStats& w, uint8_t type, const MessageWriter& msg) {
+        if (w.dead) {
+            return;
+        }
+        vector<uint8_t> frame = encode_frame(type, msg);
+        w.outbuf.insert(w.outbuf.end(), frame.begin(), frame.end());
+        if (w.outbuf.size() > MAX_OUTBUF) {
+            w.dead = true;
+            return;
+        }
+        flush(w);
+    }
+
+    void send_job(WorkerStats& w) {
+        queue_message(w, MSG_JOB, encode_job(shares.assign_range(w.ranges, config.range_size)));
+    }
+
+    void send_share_result(WorkerStats& w, ShareStatus status) {
+        MessageWriter msg;
+        msg.u8(status);
+        queue_message(w, MSG_SHARE_RESULT, msg);
+    }
+
+    void handle_share(WorkerStats& w, MessageReader& in) {
+        uint32_t share_job = in.u32();
+        uint32_t nonce = in.u32();
+
+        Block candidate(0, "", "");
+        ShareStatus status = shares.check_share(w.ranges, share_job, nonce, candidate);
+        send_share_result(w, status);
+        if (status != SHARE_ACCEPTED && status != SHARE_BLOCK) {
+            w.shares_rejected++;
+            return;
+        }
+        w.shares_accepted++;
+        if (status == SHARE_ACCEPTED) {
+            return;
+        }
+
+        w.blocks_found++;
+        blockchain.add_mined_block(candidate);
+        cout << "Block #" << candidate.index << " found by " << w.name
+             << " (nonce " << candidate.nonce << "): " << candidate.hash << endl;
+
+        if ((int)blockchain.size() > config.num_blocks) {
+            shares.close();
+            return;
+        }
+        new_template();
+        for (WorkerStats& other : workers) {
+            if (!other.name.empty()) {
+                send_job(other);
+            }
+        }
+    }
+
+    // Returns false when the connection should be dropped.
+    bool handle_message(WorkerStats& w, Message& msg) {
+        MessageReader in(msg.payload);
+        switch (msg.type) {
+            case MSG_HELLO:
+                w.name = in.str();
+                w.connected_at = steady_clock::now();
+                send_job(w);
+                return true;
+            case MSG_GET_WORK: {
+                uint32_t done_job = in.u32();
+                w.hashes_reported += in.u32();
+                // A report for an older job only carries the hash count; the
+                // worker already has the new template from the broadcast.
+                if (done_job == shares.get_job_id()) {
+                    send_job(w);
+                }
+                return true;
+            }
+            case MSG_SHARE:
+                handle_share(w, in);
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // Reads whatever is available and handles every complete frame.
+    void read_from(WorkerStats& w) {
+        bool eof = false;
+        uint8_t buf[4096];
+        while (true) {
+            ssize_t n = recv(w.fd, buf, sizeof(buf), 0);
+            if (n > 0) {
+                w.inbuf.insert(w.inbuf.end(), buf, buf + n);
+                w.last_progress = steady_clock::now();
+            } else if (n < 0 && errno == EINTR) {
+                continue;
+            } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            } else {
+                eof = true;
+                break;
+            }
+        }
+
+        Message msg;
+        while (!w.dead) {
+            int got = decode_frame(w.inbuf, msg);
+            if (got == 0) {
+                break;
+            }
+            bool keep = got > 0;
+            if (keep) {
+                try {
+                    keep = handle_message(w, msg);
+                } catch (const exception& e) {
+                    keep = false;
+                }
+            }
+            if (!keep) {
+                w.dead = true;
+            }
+        }
+        if (eof) {
+            w.dead = true;
+        }
+    }
+
+    bool is_stalled(const WorkerStats& w, steady_clock::time_point now) {
+        return (!w.inbuf.empty() || !w.outbuf.empty()) && now - w.last_progress > IO_TIMEOUT;
+    }
+
+    void drop_dead_workers() {
+        for (size_t i = workers.size(); i-- > 0;) {
+            if (!workers[i].dead) {
+                continue;
+            }
+            close(workers[i].fd);
+            if (!workers[i].name.empty()) {
+                finished.push_back(workers[i]);
+            }
+            workers.erase(workers.begin() + i);
+        }
+    }
+
+    void print_stats(const vector<WorkerStats>& all) {
+        cout << "\n+------------------+----------+----------+--------+----------------+----------------+" << endl;
+        cout << "| Worker           | Accepted | Rejected | Blocks | Est. H/s       | Reported H/s   |" << endl;
+        cout << "+------------------+----------+----------+--------+----------------+----------------+" << endl;
+
+        // Each accepted share represents 16^share_difficulty hashes on average.
+        double hashes_per_share = pow(16.0, config.share_difficulty);
+        auto now = steady_clock::now();
+        for (const WorkerStats& w : all) {
+            double secs = duration_cast<duration<double>>(now - w.connected_at).count();
+            if (secs <= 0) {
+                secs = 1e-9;
+            }
+            double estimated = w.shares_accepted * hashes_per_share / secs;
+            double reported = w.hashes_reported / secs;
+            cout << "| " << left << setw(16) << w.name.substr(0, 16) << right << " | ";
+            cout << setw(8) << w.shares_accepted << " | ";
+            cout << setw(8) << w.shares_rejected << " | ";
+            cout << setw(6) << w.blocks_found << " | ";
+            cout << setw(14) << fixed << setprecision(1) << estimated << " | ";
+            cout << setw(14) << fixed << setprecision(1) << reported << " |" << endl;
+        }
+        cout << "+------------------+----------+----------+--------+----------------+----------------+" << endl;
+    }
+
+    // Closing a socket with unread shares in it makes the kernel send a
+    // reset, which would discard the STOP before the worker reads it. Half
+    // close once the STOP is out and drain until every worker has hung up.
+    void stop_workers() {
+        for (WorkerStats& w : workers) {
+            w.inbuf.clear();
+            queue_message(w, MSG_STOP, MessageWriter());
+        }
+
+        auto deadline = steady_clock::now() + seconds(5);
+        while (!workers.empty() && steady_clock::now() < deadline) {
+            vector<pollfd> fds;
+            for (WorkerStats& w : workers) {
+                if (w.outbuf.empty() && !w.write_closed) {
+                    shutdown(w.fd, SHUT_WR);
+                    w.write_closed = true;
+                }
+                short events = POLLIN | (w.outbuf.empty() ? 0 : POLLOUT);
+                fds.push_back({w.fd, events, 0});
+            }
+            if (poll(fds.data(), fds.size(), 100) < 0 && errno != EINTR) {
+                break;
+            }
+            for (size_t i = 0; i < fds.size(); i++) {
+                WorkerStats& w = workers[i];
+                if (fds[i].revents & POLLOUT) {
+                    flush(w);
+                }
+                if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+                    uint8_t buf[4096];
+                    ssize_t n = recv(w.fd, buf, sizeof(buf), 0);
+                    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                        w.dead = true;
+                    }
+                }
+            }
+            drop_dead_workers();
+        }
+
+        for (WorkerStats& w : workers) {
+            w.dead = true;
+        }
+        drop_dead_workers();
+    }
+
+public:
+    Coordinator(const PoolConfig& cfg, int fd)
+        : config(cfg), blockchain(cfg.difficulty, cfg.mode), listen_fd(fd),
+          shares(cfg.difficulty, cfg.share_difficulty, cfg.mode) {
+        set_nonblocking(listen_fd);
+        new_template();
+    }
+
+    bool run() {
+        while (!shares.is_closed()) {
+            vector<pollfd> fds;
+            fds.push_back({listen_fd, POLLIN, 0});
+            for (WorkerStats& w : workers) {
+                short events = POLLIN | (w.outbuf.empty() ? 0 : POLLOUT);
+                fds.push_back({w.fd, events, 0});
+            }
+
+            if (poll(fds.data(), fds.size(), 1000) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw runtime_error(string("poll failed: ") + strerror(errno));
+            }
+
+            if (fds[0].revents & POLLIN) {
+                int client;
+                while ((client = accept(listen_fd, nullptr, nullptr)) >= 0) {
+                    set_nonblocking(client);
+                    workers.push_back(WorkerStats(client));
+                }
+            }
+
+            // Workers accepted above are not in `fds` yet; they are polled
+            // from the next iteration on.
+            for (size_t i = 1; i < fds.size(); i++) {
+                WorkerStats& w = workers[i - 1];
+                if (fds[i].revents & POLLOUT) {
+                    flush(w);
+                }
+                if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+                    read_from(w);
+                }
+            }
+
+            auto now = steady_clock::now();
+            for (WorkerStats& w : workers) {
+                if (is_stalled(w, now)) {
+                    cerr << "Dropping stalled worker " << (w.name.empty() ? "(unnamed)" : w.name) << endl;
+                    w.dead = true;
+                }
+            }
+            drop_dead_workers();
+        }
+
+        stop_workers();
+
+        sort(finished.begin(), finished.end(), [](const WorkerStats& a, const WorkerStats& b) {
+            return a.name < b.name;
+        });
+        print_stats(finished);
+        bool valid = blockchain.is_chain_valid();
+        cout << "Chain valid: " << (valid ? "YES" : "NO") << endl;
+        return valid;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Worker
+// ---------------------------------------------------------------------------
+
+bool has_pending_message(int fd) {
+    pollfd p = {fd, POLLIN, 0};
+    return poll(&p, 1, 0) > 0;
+}
+
+int run_worker(const Endpoint& ep, const string& name) {
+    int fd = connect_to(ep);
+
+    MessageWriter hello;
+    hello.str(name);
+    send_message(fd, MSG_HELLO, hello);
+
+    uint64_t total_hashes = 0;
+    uint64_t shares_sent = 0;
+    uint64_t accepted = 0;
+    Message msg;
+
+    // Share results are only counted; anything else (a new job, a stop
+    // request or a closed socket) ends the current range.
+    auto is_share_result = [&](const Message& m) {
+        if (m.type != MSG_SHARE_RESULT) {
+            return false;
+        }
+        MessageReader in(m.payload);
+        uint8_t status = in.u8();
+        if (status == SHARE_ACCEPTED || status == SHARE_BLOCK) {
+            accepted++;
+        }
+        return true;
+    };
+
+    bool have_msg = recv_message(fd, msg);
+    while (have_msg) {
+        if (is_share_result(msg)) {
+            have_msg = recv_message(fd, msg);
+            continue;
+        }
+        if (msg.type != MSG_JOB) {
+            break;
+        }
+
+        Job job = parse_job(msg);
+        uint32_t hashes = 0;
+        bool interrupted = false;
+
+        for (uint32_t i = 0; i < job.nonce_count && !interrupted; i++) {
+            job.block.nonce = (int)(job.nonce_start + i);
+            string hash = job.block.calculate_hash(job.mode);
+            hashes++;
+
+            if (meets_target(hash, job.share_difficulty)) {
+                MessageWriter share;
+                share.u32(job.id);
+                share.u32(job.nonce_start + i);
+                send_message(fd, MSG_SHARE, share);
+                shares_sent++;
+            }
+
+            // Check for a new template or a stop request without blocking.
+            if ((i & 15) == 15) {
+                while (has_pending_message(fd)) {
+                    have_msg = recv_message(fd, msg);
+                    if (!have_msg || !is_share_result(msg)) {
+                        interrupted = true;
+                        break;
+                    }
+                }
+            }
+        }
+        total_hashes += hashes;
+
+        MessageWriter done;
+        done.u32(job.id);
+        done.u32(hashes);
+        send_message(fd, MSG_GET_WORK, done);
+
+        if (!interrupted) {
+            have_msg = recv_message(fd, msg);
+        }
+    }
+
+    close(fd);
+    cout << "[" << name << "] hashes: " << total_hashes << ", shares sent: " << shares_sent
+         << ", accepted: " << accepted << endl;
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Entry points
+// ---------------------------------------------------------------------------
+
+HashMode parse_mode(const string& s) {
+    return s == "ac" ? AC_HASH_MODE : SHA256_MODE;
+}
+
+// Runs a coordinator and forks `num_workers` worker processes against it on
+// the given endpoint, so the whole pool can be exercised on one machine.
+int run_demo(Endpoint ep, int num_workers, const PoolConfig& config) {
+    int listen_fd = listen_on(ep);
+    cout << "Coordinator listening on " << format_endpoint(ep) << " with " << num_workers << " workers" << endl;
+    cout << "Difficulty " << config.difficulty << ", share difficulty " << config.share_difficulty
+         << ", " << (config.mode == SHA256_MODE ? "SHA256" : "AC_HASH") << endl << endl;
+
+    vector<pid_t> children;
+    for (int i = 0; i < num_workers; i++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(listen_fd);
+            int rc = 1;
+            try {
+                rc = run_worker(ep, "worker-" + to_string(i + 1));
+            } catch (const exception& e) {
+                cerr << e.what() << endl;
+            }
+            _exit(rc);
+        }
+        children.push_back(pid);
+    }
+
+    bool valid = Coordinator(config, listen_fd).run();
+    close_listener(listen_fd, ep);
+
+    for (pid_t pid : children) {
+        waitpid(pid, nullptr, 0);
+    }
+    return valid ? 0 : 1;
+}
+
+void usage() {
+    cout << "Usage:" << endl;
+    cout << "  ex5 [demo [workers] [blocks] [difficulty] [share_difficulty] [sha|ac] [endpoint]]" << endl;
+    cout << "  ex5 coordinator <endpoint> [blocks] [difficulty] [share_difficulty] [sha|ac]" << endl;
+    cout << "  ex5 worker <endpoint> [name]" << endl;
+    cout << "Endpoints: tcp:pool-host:5555, tcp:[::1]:5555 or unix:/tmp/pool.sock" << endl;
+}
+
+int main(int argc, char** argv) {
+    signal(SIGPIPE, SIG_IGN);
+
+    vector<string> args(argv + 1, argv + argc);
+    string command = args.empty() ? "demo" : args[0];
+
+    // AC_HASH mixes only ~100 cells per side, so the leading hex digits
+    // depend on the block prefix and not on the nonce; SHA256 is the default.
+    PoolConfig config = {4, 2, SHA256_MODE, 5, 1 << 12};
+
+    try {
+        if (command == "demo") {
+            int num_workers = args.size() > 1 ? stoi(args[1]) : 4;
+            if (args.size() > 2) config.num_blocks = stoi(args[2]);
+            if (args.size() > 3) config.difficulty = stoi(args[3]);
+            if (args.size() > 4) config.share_difficulty = stoi(args[4]);
+            if (args.size() > 5) config.mode = parse_mode(args[5]);
+            Endpoint ep = parse_endpoint(args.size() > 6 ? args[6] : "tcp:127.0.0.1:0");
+            return run_demo(ep, num_workers, config);
+        }
+        if (command == "coordinator" && args.size() > 1) {
+            Endpoint ep = parse_endpoint(args[1]);
+            if (args.size() > 2) config.num_blocks = stoi(args[2]);
+            if (args.size() > 3) config.difficulty = stoi(args[3]);
+            if (args.size() > 4) config.share_difficulty = stoi(args[4]);
+            if (args.size() > 5) config.mode = parse_mode(args[5]);
+            int listen_fd = listen_on(ep);
+            cout << "Coordinator listening on " << format_endpoint(ep) << endl;
+            bool valid = Coordinator(config, listen_fd).run();
+            close_listener(listen_fd, ep);
+            return valid ? 0 : 1;
+        }
+        if (command == "worker" && args.size() > 1) {
+            string name = args.size() > 2 ? args[2] : "worker-" + to_string(getpid());
+            return run_worker(parse_endpoint(args[1]), name);
+        }
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+
+    usage();
+    return 1;
+}
@@ -0,0 +1,353 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <cstdio>
+#include <openssl/evp.h>
+
+#include "blockchain/blockchain.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// ---------------------------------------------------------------------------
+// Snapshot file
+//
+// A snapshot holds the tip block and the hash of every `interval`-th block up
+// to the tip. The serialized body is hashed with SHA-256 and that digest is
+// signed with Ed25519, so a new node only needs the publisher's public key.
+//
+// Layout (integers big-endian, hashes as 32 raw bytes):
+//   "ACSNAP02" | mode u8 | difficulty u8 | interval u32
+//   tip: index u32 | data str | previous_hash str | timestamp i64 |
+//        target u64 | nonce u32 | hash
+//   count u32 | count x (height u32 | hash)
+//   digest (32 bytes) | signature (64 bytes)
+// ---------------------------------------------------------------------------
+
+const string SNAPSHOT_MAGIC = "ACSNAP02";
+const size_t SIGNATURE_SIZE = 64;
+
+struct SignedSnapshot {
+    Snapshot snap;
+    string digest;
+    string signature;
+};
+
+void put_u32(string& out, uint32_t v) {
+    for (int i = 3; i >= 0; i--) {
+        out.push_back((char)((v >> (i * 8)) & 0xff));
+    }
+}
+
+void put_i64(string& out, int64_t v) {
+    for (int i = 7; i >= 0; i--) {
+        out.push_back((char)(((uint64_t)v >> (i * 8)) & 0xff));
+    }
+}
+
+void put_str(string& out, const string& s) {
+    put_u32(out, s.size());
+    out += s;
+}
+
+void put_hash(string& out, const string& hex_hash) {
+    for (size_t i = 0; i + 1 < hex_hash.size(); i += 2) {
+        out.push_back((char)stoul(hex_hash.substr(i, 2), nullptr, 16));
+    }
+}
+
+class SnapshotReader {
+private:
+    const string& bytes;
+    size_t pos;
+
+public:
+    bool ok;
+
+    SnapshotReader(const string& b) : bytes(b), pos(0), ok(true) {}
+
+    bool need(size_t n) {
+        if (pos + n > bytes.size()) {
+            ok = false;
+        }
+        return ok;
+    }
+
+    uint32_t u32() {
+        if (!need(4)) return 0;
+        uint32_t v = 0;
+        for (int i = 0; i < 4; i++) {
+            v = (v << 8) | (uint8_t)bytes[pos++];
+        }
+        return v;
+    }
+
+    int64_t i64() {
+        if (!need(8)) return 0;
+        uint64_t v = 0;
+        for (int i = 0; i < 8; i++) {
+            v = (v << 8) | (uint8_t)bytes[pos++];
+        }
+        return (int64_t)v;
+    }
+
+    uint8_t u8() {
+        if (!need(1)) return 0;
+        return (uint8_t)bytes[pos++];
+    }
+
+    string raw(size_t n) {
+        if (!need(n)) return "";
+        string s = bytes.substr(pos, n);
+        pos += n;
+        return s;
+    }
+
+    string str() {
+        uint32_t len = u32();
+        return raw(len);
+    }
+
+    string hash() {
+        string r = raw(32);
+        stringstream ss;
+        for (unsigned char c : r) {
+            ss << hex << setw(2) << setfill('0') << (int)c;
+        }
+        return ss.str();
+    }
+
+    size_t position() {
+        return pos;
+    }
+};
+
+string snapshot_body(const Snapshot& snap) {
+    string out = SNAPSHOT_MAGIC;
+    out.push_back((char)snap.mode);
+    out.push_back((char)snap.difficulty);
+    put_u32(out, snap.interval);
+
+    put_u32(out, snap.tip.index);
+    put_str(out, snap.tip.data);
+    put_str(out, snap.tip.previous_hash);
+    put_i64(out, snap.tip.timestamp);
+    put_i64(out, (int64_t)snap.tip.target);
+    put_u32(out, snap.tip.nonce);
+    put_hash(out, snap.tip.hash);
+
+    put_u32(out, snap.checkpoints.size());
+    for (const Checkpoint& cp : snap.checkpoints) {
+        put_u32(out, cp.height);
+        put_hash(out, cp.hash);
+    }
+    return out;
+}
+
+// The demo derives its Ed25519 key from a fixed 32 byte seed. A real
+// deployment would keep the seed offline and ship only the public key.
+EVP_PKEY* load_signing_key(const string& seed) {
+    string s = sha256_digest(seed);
+    return EVP_PKEY_new_raw_private_key(EVP_PKEY_ED25519, nullptr,
+                                        (const unsigned char*)s.data(), s.size());
+}
+
+string public_key_of(EVP_PKEY* key) {
+    unsigned char pub[32];
+    size_t len = sizeof(pub);
+    if (EVP_PKEY_get_raw_public_key(key, pub, &len) != 1) {
+        return "";
+    }
+    return string((const char*)pub, len);
+}
+
+bool sign_snapshot(SignedSnapshot& signed_snap, EVP_PKEY* key) {
+    signed_snap.digest = sha256_digest(snapshot_body(signed_snap.snap));
+
+    unsigned char sig[SIGNATURE_SIZE];
+    size_t sig_len = sizeof(sig);
+    EVP_MD_CTX* ctx = EVP_MD_CTX_new();
+    bool ok = ctx &&
+              EVP_DigestSignInit(ctx, nullptr, nullptr, nullptr, key) == 1 &&
+              EVP_DigestSign(ctx, sig, &sig_len,
+                             (const unsigned char*)signed_snap.digest.data(),
+                             signed_snap.digest.size()) == 1;
+    EVP_MD_CTX_free(ctx);
+    if (ok) {
+        signed_snap.signature = string((const char*)sig, sig_len);
+    }
+    return ok;
+}
+
+bool verify_snapshot(const SignedSnapshot& signed_snap, const string& public_key) {
+    const string& digest = signed_snap.digest;
+    const string& signature = signed_snap.signature;
+    if (sha256_digest(snapshot_body(signed_snap.snap)) != digest) {
+        return false;
+    }
+
+    EVP_PKEY* key = EVP_PKEY_new_raw_public_key(EVP_PKEY_ED25519, nullptr,
+                                                (const unsigned char*)public_key.data(),
+                                                public_key.size());
+    EVP_MD_CTX* ctx = EVP_MD_CTX_new();
+    bool ok = key && ctx &&
+              EVP_DigestVerifyInit(ctx, nullptr, nullptr, nullptr, key) == 1 &&
+              EVP_DigestVerify(ctx, (const unsigned char*)signature.data(), signature.size(),
+                               (const unsigned char*)digest.data(), digest.size()) == 1;
+    EVP_MD_CTX_free(ctx);
+    EVP_PKEY_free(key);
+    return ok;
+}
+
+bool write_snapshot(const string& path, const SignedSnapshot& signed_snap) {
+    ofstream out(path, ios::binary);
+    string bytes = snapshot_body(signed_snap.snap) + signed_snap.digest + signed_snap.signature;
+    out.write(bytes.data(), bytes.size());
+    return (bool)out;
+}
+
+bool read_snapshot(const string& path, SignedSnapshot& signed_snap) {
+    ifstream in(path, ios::binary);
+    if (!in) {
+        return false;
+    }
+    string bytes((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+
+    Snapshot& snap = signed_snap.snap;
+    SnapshotReader r(bytes);
+    if (r.raw(SNAPSHOT_MAGIC.size()) != SNAPSHOT_MAGIC) {
+        return false;
+    }
+    snap.mode = (HashMode)r.u8();
+    snap.difficulty = r.u8();
+    snap.interval = r.u32();
+
+    snap.tip.index = r.u32();
+    snap.tip.data = r.str();
+    snap.tip.previous_hash = r.str();
+    snap.tip.timestamp = r.i64();
+    snap.tip.target = (uint64_t)r.i64();
+    snap.tip.nonce = r.u32();
+    snap.tip.hash = r.hash();
+
+    uint32_t count = r.u32();
+    snap.checkpoints.clear();
+    for (uint32_t i = 0; i < count && r.ok; i++) {
+        uint32_t height = r.u32();
+        snap.checkpoints.push_back({height, r.hash()});
+    }
+
+    signed_snap.digest = r.raw(32);
+    signed_snap.signature = r.raw(SIGNATURE_SIZE);
+    return r.ok && r.position() == bytes.size();
+}
+
+// ---------------------------------------------------------------------------
+// Demo
+// ---------------------------------------------------------------------------
+
+double elapsed_ms(high_resolution_clock::time_point start) {
+    return duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1000.0;
+}
+
+int main(int argc, char** argv) {
+    int num_blocks = argc > 1 ? stoi(argv[1]) : 300;
+    // AC_HASH prefixes barely depend on the nonce, so mining with it can stall
+    // at any non-zero difficulty; use "ac 0" to time AC_HASH validation.
+    HashMode mode = (argc > 2 && string(argv[2]) == "ac") ? AC_HASH_MODE : SHA256_MODE;
+    int difficulty = argc > 3 ? stoi(argv[3]) : 2;
+    const uint32_t INTERVAL = 50;
+    const string SNAPSHOT_PATH = "chain.snap";
+
+    // The tampering checks edit blocks INTERVAL / 2 and INTERVAL, which must
+    // both sit below the checkpoint.
+    const int MIN_BLOCKS = INTERVAL * 2;
+    if (num_blocks < MIN_BLOCKS) {
+        cout << "Using the minimum of " << MIN_BLOCKS << " blocks" << endl;
+        num_blocks = MIN_BLOCKS;
+    }
+
+    // Never pick up a snapshot left over from an earlier run.
+    remove(SNAPSHOT_PATH.c_str());
+
+    cout << "=== Building chain of " << num_blocks << " blocks ("
+         << (mode == SHA256_MODE ? "SHA256" : "AC_HASH") << ", difficulty " << difficulty << ") ===" << endl;
+    Blockchain full_node(difficulty, mode);
+    int checkpoint_at = num_blocks - num_blocks / 10;
+    for (int i = 1; i <= num_blocks; i++) {
+        full_node.add_block(Block(i, "Transaction " + to_string(i), ""));
+        if (i == checkpoint_at) {
+            EVP_PKEY* key = load_signing_key("blockchain-workshop checkpoint key");
+            SignedSnapshot signed_snap;
+            signed_snap.snap = full_node.create_snapshot(INTERVAL);
+            bool written = sign_snapshot(signed_snap, key) && write_snapshot(SNAPSHOT_PATH, signed_snap);
+            EVP_PKEY_free(key);
+            if (!written) {
+                cout << "Could not sign and write " << SNAPSHOT_PATH << endl;
+                return 1;
+            }
+            cout << "Snapshot written at height " << i << " with "
+                 << signed_snap.snap.checkpoints.size() << " commitments" << endl;
+        }
+    }
+
+    EVP_PKEY* key = load_signing_key("blockchain-workshop checkpoint key");
+    string trusted_public_key = public_key_of(key);
+    EVP_PKEY_free(key);
+
+    cout << endl << "=== Full validation from genesis ===" << endl;
+    auto start = high_resolution_clock::now();
+    bool full_ok = full_node.is_chain_valid();
+    cout << "Chain valid: " << (full_ok ? "YES" : "NO") << " in " << elapsed_ms(start) << " ms" << endl;
+
+    cout << endl << "=== Fast sync from snapshot ===" << endl;
+    start = high_resolution_clock::now();
+    SignedSnapshot signed_snap;
+    if (!read_snapshot(SNAPSHOT_PATH, signed_snap) || !verify_snapshot(signed_snap, trusted_public_key)) {
+        cout << "Snapshot rejected" << endl;
+        return 1;
+    }
+    Blockchain new_node(difficulty, mode);
+    const Snapshot& snap = signed_snap.snap;
+    bool fast_ok = new_node.fast_sync(full_node.get_blocks(), snap);
+    cout << "Chain valid: " << (fast_ok ? "YES" : "NO") << " in " << elapsed_ms(start) << " ms"
+         << " (trusted up to height " << new_node.get_trusted_height() << ")" << endl;
+
+    new_node.start_background_validation();
+    start = high_resolution_clock::now();
+    bool confirmed = new_node.wait_background_validation();
+    cout << "Background validation: " << (confirmed ? "snapshot confirmed" : "FAILED")
+         << " in " << elapsed_ms(start) << " ms" << endl;
+
+    cout << endl << "=== Tampering checks ===" << endl;
+    SignedSnapshot forged = signed_snap;
+    forged.snap.tip.nonce++;
+    cout << "Forged snapshot accepted: "
+         << (verify_snapshot(forged, trusted_public_key) ? "YES" : "NO") << endl;
+
+    vector<Block> blocks = full_node.get_blocks();
+    blocks[INTERVAL].hash[63] = blocks[INTERVAL].hash[63] == '0' ? '1' : '0';
+    Blockchain node_b(difficulty, mode);
+    cout << "Chain with altered committed hash accepted: "
+         << (node_b.fast_sync(blocks, snap) ? "YES" : "NO") << endl;
+
+    blocks = full_node.get_blocks();
+    blocks[INTERVAL / 2].data = "Transaction rewritten";
+    Blockchain node_c(difficulty, mode);
+    bool accepted = node_c.fast_sync(blocks, snap);
+    node_c.start_background_validation();
+    bool caught = !node_c.wait_background_validation();
+    cout << "Chain with rewritten trusted block accepted by fast sync: " << (accepted ? "YES" : "NO") << endl;
+    cout << "Caught by background validation: " << (caught ? "YES" : "NO");
+    if (caught) {
+        cout << " (block #" << node_c.get_background_failed_at() << "), chain rolled back to "
+             << node_c.size() << " blocks";
+    }
+    cout << endl;
+
+    return full_ok && fast_ok && confirmed ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <iomanip>
+
+#include "blockchain/blockchain.h"
+
+using namespace std;
+
+// Blockchain::add_block, but `slowdown` repeats each hash to simulate a
+// miner with a fraction of the capacity; only the last result is used.
+void add_throttled_block(Blockchain& blockchain, Block block, HashMode mode, int slowdown) {
+    blockchain.prepare_block(block);
+    int iterations = 0;
+    
+    do {
+        block.nonce++;
+        iterations++;
+        for (int i = 1; i < slowdown; i++) {
+            block.calculate_hash(mode);
+        }
+        block.hash = block.calculate_hash(mode);
+    } while (!block.has_valid_proof(0));
+    
+    blockchain.add_mined_block(block, iterations);
+}
+
+// ---------------------------------------------------------------------------
+// Demo
+// ---------------------------------------------------------------------------
+
+void print_header() {
+    cout << "+--------+------------+----------+--------------+------------------+" << endl;
+    cout << "| Height | Solve(ms)  | Attempts |  Difficulty  | Est. Hashrate H/s|" << endl;
+    cout << "+--------+------------+----------+--------------+------------------+" << endl;
+}
+
+// Formats into a local stream so cout keeps its default float format.
+void print_row(const BlockTelemetry& t) {
+    ostringstream row;
+    row << "| " << setw(6) << t.height << " | ";
+    row << setw(10) << fixed << setprecision(1) << t.solve_ms << " | ";
+    row << setw(8) << t.attempts << " | ";
+    row << setw(12) << fixed << setprecision(0) << t.difficulty << " | ";
+    row << setw(16) << fixed << setprecision(0) << t.hashrate << " |";
+    cout << row.str() << endl;
+}
+
+// Mines three phases: full capacity, a quarter of the capacity, then full
+// capacity again, and reports the mean block time of each phase.
+bool run_simulation(const string& name, RetargetConfig cfg, int blocks_per_phase, ofstream& csv) {
+    cout << "=== " << name << " (target " << cfg.block_time_ms << " ms, every "
+         << cfg.interval << " blocks) ===" << endl;
+
+    Blockchain blockchain(3, SHA256_MODE, cfg);
+    blockchain.subscribe(print_row);
+    blockchain.subscribe([&](const BlockTelemetry& t) {
+        csv << name << "," << t.height << "," << t.solve_ms << "," << t.attempts << ","
+            << t.target << "," << t.difficulty << "," << t.hashrate << "\n";
+    });
+
+    const int slowdowns[3] = {1, 4, 1};
+    print_header();
+    for (int phase = 0; phase < 3; phase++) {
+        for (int i = 0; i < blocks_per_phase; i++) {
+            int index = phase * blocks_per_phase + i + 1;
+            add_throttled_block(blockchain, Block(index, "Transaction " + to_string(index), ""),
+                                SHA256_MODE, slowdowns[phase]);
+        }
+        if (phase < 2) {
+            string label = phase == 0 ? "| -- capacity drops to 1/4 " : "| -- capacity back to full ";
+            cout << label << string(67 - label.size(), '-') << "|" << endl;
+        }
+    }
+    cout << "+--------+------------+----------+--------------+------------------+" << endl;
+
+    // Skip the first window of each phase, which is still converging.
+    const vector<BlockTelemetry>& t = blockchain.get_telemetry();
+    for (int phase = 0; phase < 3; phase++) {
+        double total = 0;
+        int count = 0;
+        for (int i = phase * blocks_per_phase + cfg.interval * 2; i < (phase + 1) * blocks_per_phase; i++) {
+            total += t[i].solve_ms;
+            count++;
+        }
+        ostringstream mean;
+        mean << fixed << setprecision(1) << (count ? total / count : 0);
+        cout << "Phase " << (phase + 1) << " (capacity x" << (phase == 1 ? "1/4" : "1")
+             << ") mean block time after settling: " << mean.str() << " ms" << endl;
+    }
+
+    bool valid = blockchain.is_chain_valid();
+    cout << "Chain valid: " << (valid ? "YES" : "NO") << endl << endl;
+    return valid;
+}
+
+int main(int argc, char** argv) {
+    string which = argc > 1 ? argv[1] : "both";
+    int blocks_per_phase = argc > 2 ? stoi(argv[2]) : 20;
+    double block_time_ms = argc > 3 ? stod(argv[3]) : 100;
+    if (!(block_time_ms > 0)) {
+        cerr << "block_time_ms must be positive" << endl;
+        return 1;
+    }
+
+    ofstream csv("telemetry.csv");
+    csv << "algorithm,height,solve_ms,attempts,target,difficulty,hashrate\n";
+
+    bool ok = true;
+    if (which == "window" || which == "both") {
+        RetargetConfig cfg = {WINDOW_RETARGET, 4, block_time_ms, 0, 4.0};
+        ok = run_simulation("Moving window", cfg, blocks_per_phase, csv) && ok;
+    }
+    if (which == "exp" || which == "both") {
+        RetargetConfig cfg = {EXPONENTIAL_RETARGET, 1, block_time_ms, block_time_ms * 4, 0};
+        ok = run_simulation("Exponential", cfg, blocks_per_phase, csv) && ok;
+    }
+
+    cout << "Telemetry written to telemetry.csv" << endl;
+    return ok ? 0 : 1;
+}
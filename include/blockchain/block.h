@@ -0,0 +1,57 @@
+#ifndef BLOCKCHAIN_BLOCK_H
+#define BLOCKCHAIN_BLOCK_H
+
+#include "blockchain/hash.h"
+
+#include <cstdint>
+#include <string>
+
+// Numeric proof-of-work targets. A block with a non-zero `target` is valid
+// when the first 64 bits of its hash, read as an unsigned integer, are <=
+// the target. "Difficulty d" (d leading hex zeros) is the special case
+// target = 16^(16-d) - 1, but a target can move by any factor.
+const uint64_t MAX_TARGET = UINT64_MAX;
+
+uint64_t difficulty_to_target(int difficulty);
+
+// True for a 64 character hex string, the shape of every hash we produce.
+bool is_hex_hash(const std::string& hash);
+
+// First 64 bits of a hex hash as an integer. Throws std::invalid_argument
+// if `hash` does not start with a hex digit; check is_hex_hash() first.
+uint64_t hash_value(const std::string& hash);
+
+// Average number of hashes needed to meet `target`.
+double expected_hashes(uint64_t target);
+
+// Milliseconds since the epoch, the unit of Block::timestamp.
+int64_t now_ms();
+
+class Block {
+public:
+    int index;
+    std::string data;
+    std::string previous_hash;
+    int64_t timestamp;
+    uint64_t target;  // 0 when the chain uses a fixed hex-zero difficulty
+    int nonce;
+    std::string hash;
+
+    Block(int idx, std::string d, std::string prev_hash);
+
+    // The target is only part of the hashed header when it is set.
+    std::string calculate_hash(HashMode mode) const;
+
+    // True when `hash` is well formed and meets the block's numeric target
+    // or, for blocks without one, starts with `difficulty` hex zeros.
+    bool has_valid_proof(int difficulty) const;
+
+    // Increments the nonce until has_valid_proof(difficulty) holds.
+    // Returns the number of hashes computed.
+    int mine_block(int difficulty, HashMode mode);
+};
+
+// True when `hash` starts with `difficulty` '0' characters.
+bool meets_target(const std::string& hash, int difficulty);
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef BLOCKCHAIN_BLOCKCHAIN_H
+#define BLOCKCHAIN_BLOCKCHAIN_H
+
+#include "blockchain/block.h"
+#include "blockchain/retarget.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct Checkpoint {
+    uint32_t height;
+    std::string hash;
+};
+
+// Tip block plus the hash of every `interval`-th block below it. Producing
+// and checking the signature over a snapshot is left to the caller.
+struct Snapshot {
+    HashMode mode;
+    int difficulty;
+    uint32_t interval;
+    Block tip;
+    std::vector<Checkpoint> checkpoints;
+
+    Snapshot() : mode(SHA256_MODE), difficulty(0), interval(0), tip(0, "", "") {}
+};
+
+enum BackgroundState {
+    BACKGROUND_IDLE,
+    BACKGROUND_RUNNING,
+    BACKGROUND_CONFIRMED,
+    BACKGROUND_FAILED
+};
+
+class Blockchain {
+private:
+    std::vector<Block> chain;
+    int difficulty;
+    HashMode hash_mode;
+    RetargetConfig retarget;
+    std::vector<BlockTelemetry> telemetry;
+    std::vector<std::function<void(const BlockTelemetry&)>> subscribers;
+
+    // Blocks at or below this height were accepted on the strength of a
+    // snapshot and have not had their hashes recomputed yet.
+    size_t trusted_height;
+
+    std::thread background;
+    std::atomic<int> background_state;
+    std::atomic<size_t> background_failed_at;
+
+    // Everything about blocks[i] except its hash: index, linkage, timestamp,
+    // target and proof of work.
+    bool check_link(const std::vector<Block>& blocks, size_t i) const;
+    void background_validate(std::vector<Block> prefix);
+    void record_telemetry(const Block& block, double solve_ms, int attempts);
+    double estimate_hashrate() const;
+
+public:
+    // With a retargeting `cfg` the genesis target is difficulty_to_target(diff)
+    // and every later block must carry target_for_height(); otherwise blocks
+    // carry no target and need `diff` leading hex zeros. Throws
+    // std::invalid_argument for a config validate_retarget_config() rejects.
+    Blockchain(int diff, HashMode mode, RetargetConfig cfg = NO_RETARGETING);
+    ~Blockchain();
+
+    Blockchain(const Blockchain&) = delete;
+    Blockchain& operator=(const Blockchain&) = delete;
+
+    Block create_genesis_block();
+    Block get_last_block() const;
+    const std::vector<Block>& get_blocks() const;
+    size_t size() const;
+
+    // Target the next block must carry.
+    uint64_t next_target() const;
+    uint64_t target_for_height(size_t height) const;
+
+    // Links `block` to the tip and sets its target. The timestamp is raised
+    // to just past the median time if needed, so the block stays valid when
+    // it is mined within the same millisecond as its parents.
+    void prepare_block(Block& block) const;
+
+    // Prepares `new_block`, mines it and appends it. Returns the number of
+    // hashes computed.
+    int add_block(Block new_block);
+
+    // Appends a block whose proof of work was already checked elsewhere,
+    // e.g. a share submitted by a pool worker. Its solve time is measured
+    // from the block timestamp.
+    void add_mined_block(const Block& block, int attempts = 0);
+
+    // Registers a callback that receives telemetry for every new block.
+    void subscribe(std::function<void(const BlockTelemetry&)> callback);
+    const std::vector<BlockTelemetry>& get_telemetry() const;
+
+    bool is_chain_valid() const;
+    void print_chain() const;
+
+    // Commits to the current tip and to every `interval`-th block below it.
+    Snapshot create_snapshot(uint32_t interval) const;
+
+    // Adopts `blocks` using a verified snapshot. Blocks up to the snapshot tip
+    // only get a linkage check against the committed hashes; blocks after it
+    // are fully validated. Hash work is proportional to the blocks since the
+    // checkpoint, not to the chain length. On failure the chain is unchanged.
+    bool fast_sync(const std::vector<Block>& blocks, const Snapshot& snap);
+
+    // Recomputes the hashes of the trusted prefix on a low-priority thread.
+    void start_background_validation();
+
+    // Blocks until the background pass finishes. On success the snapshot is
+    // confirmed. On failure the chain is truncated to the blocks below
+    // get_background_failed_at(), which were all rehashed, so later blocks
+    // extend a verified chain. Either way nothing is trusted any more.
+    bool wait_background_validation();
+
+    size_t get_trusted_height() const;
+    size_t get_background_failed_at() const;
+};
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef BLOCKCHAIN_CELLULAR_AUTOMATON_H
+#define BLOCKCHAIN_CELLULAR_AUTOMATON_H
+
+#include <vector>
+
+// 1D binary cellular automaton with neighborhood radius 1 and fixed zero
+// boundaries. `rule` is the Wolfram rule number (30, 90, 110, ...).
+class CellularAutomaton {
+private:
+    std::vector<int> state;
+    int rule;
+
+    int get_next_cell(int left, int center, int right) const {
+        int index = (left << 2) | (center << 1) | right;
+        return (rule >> index) & 1;
+    }
+
+public:
+    CellularAutomaton(int r);
+
+    void init_state(const std::vector<int>& initial);
+    void evolve();
+    void print() const;
+    std::vector<int> get_state() const;
+};
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef BLOCKCHAIN_HASH_H
+#define BLOCKCHAIN_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+enum HashMode {
+    SHA256_MODE,
+    AC_HASH_MODE
+};
+
+// Cellular automaton hash: evolves the input bits (padded to 256, folded
+// to 512) for `steps` generations of `rule` and returns 64 hex characters.
+std::string ac_hash(const std::string& input, uint32_t rule, size_t steps);
+
+// SHA-256 as 64 lowercase hex characters.
+std::string sha256_hash(const std::string& input);
+
+// SHA-256 as 32 raw bytes.
+std::string sha256_digest(const std::string& input);
+
+#endif
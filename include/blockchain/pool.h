@@ -0,0 +1,152 @@
+#ifndef BLOCKCHAIN_POOL_H
+#define BLOCKCHAIN_POOL_H
+
+#include "blockchain/block.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Pool wire protocol
+//
+// Every message is a 5 byte header (1 byte type, 4 byte big-endian payload
+// length) followed by the payload. Integers are big-endian, hashes travel as
+// 32 raw bytes and strings are prefixed with a 2 byte length. Socket I/O is
+// left to the caller.
+// ---------------------------------------------------------------------------
+
+enum MessageType : uint8_t {
+    MSG_HELLO = 1,         // worker -> coordinator: name
+    MSG_JOB = 2,           // coordinator -> worker: block template + nonce range
+    MSG_SHARE = 3,         // worker -> coordinator: job_id, nonce
+    MSG_GET_WORK = 4,      // worker -> coordinator: job_id, hashes done in range
+    MSG_SHARE_RESULT = 5,  // coordinator -> worker: ShareStatus
+    MSG_STOP = 6           // coordinator -> worker: no more work
+};
+
+enum ShareStatus : uint8_t {
+    SHARE_ACCEPTED = 0,
+    SHARE_BLOCK = 1,
+    SHARE_STALE = 2,
+    SHARE_DUPLICATE = 3,
+    SHARE_INVALID = 4
+};
+
+const size_t HEADER_SIZE = 5;
+const uint32_t MAX_PAYLOAD = 1 << 16;
+
+struct Message {
+    uint8_t type;
+    std::vector<uint8_t> payload;
+};
+
+class MessageWriter {
+public:
+    std::vector<uint8_t> bytes;
+
+    void u8(uint8_t v);
+    void u32(uint32_t v);
+    void i64(int64_t v);
+    void str(const std::string& s);
+    void hash(const std::string& hex_hash);
+};
+
+// Reads fields in order; throws std::runtime_error when the payload is too
+// short for the next field.
+class MessageReader {
+private:
+    const std::vector<uint8_t>& bytes;
+    size_t pos;
+
+    void need(size_t n);
+
+public:
+    MessageReader(const std::vector<uint8_t>& b) : bytes(b), pos(0) {}
+
+    uint8_t u8();
+    uint32_t u32();
+    int64_t i64();
+    std::string str();
+    std::string hash();
+};
+
+std::vector<uint8_t> encode_frame(uint8_t type, const MessageWriter& w);
+
+// Payload length from a HEADER_SIZE byte header.
+uint32_t frame_length(const uint8_t* header);
+
+// Takes one complete frame off the front of `buf`. Returns 1 when `msg` was
+// filled, 0 when more bytes are needed and -1 for an oversized frame.
+int decode_frame(std::vector<uint8_t>& buf, Message& msg);
+
+// A block template plus the nonce range one worker should search.
+struct Job {
+    uint32_t id;
+    Block block;
+    int difficulty;
+    int share_difficulty;
+    HashMode mode;
+    uint32_t nonce_start;
+    uint32_t nonce_count;
+};
+
+MessageWriter encode_job(const Job& job);
+Job parse_job(const Message& msg);
+
+// ---------------------------------------------------------------------------
+// Share validation
+// ---------------------------------------------------------------------------
+
+// [start, start + count) nonce ranges handed to one worker for the current job.
+typedef std::vector<std::pair<uint32_t, uint32_t>> NonceRanges;
+
+bool owns_nonce(const NonceRanges& ranges, uint32_t nonce);
+
+// Tracks the current job and checks submitted shares against it. Checking a
+// share costs a single hash: rebuild the template with the submitted nonce
+// and compare against the share and block targets.
+class ShareValidator {
+private:
+    int difficulty;
+    int share_difficulty;
+    HashMode hash_mode;
+
+    Block current;
+    uint32_t job_id;
+    uint32_t next_nonce;
+    std::set<uint32_t> seen_nonces;
+
+    // Set once the last block is in; later shares are stale even though
+    // job_id did not move.
+    bool closed;
+
+public:
+    ShareValidator(int diff, int share_diff, HashMode mode);
+
+    // Starts a new job for `block`. Shares for earlier jobs become stale,
+    // and callers must clear every worker's NonceRanges.
+    void new_job(const Block& block);
+
+    // Makes every further share stale.
+    void close();
+    bool is_closed() const;
+
+    uint32_t get_job_id() const;
+    const Block& get_template() const;
+
+    // Hands out the next `count` nonces of the current job and records them
+    // in `ranges`.
+    Job assign_range(NonceRanges& ranges, uint32_t count);
+
+    // Checks, in order: stale job, nonce outside `ranges`, repeated nonce,
+    // share difficulty, block target. For SHARE_ACCEPTED and SHARE_BLOCK
+    // `candidate` holds the hashed block.
+    ShareStatus check_share(const NonceRanges& ranges, uint32_t job, uint32_t nonce,
+                            Block& candidate);
+};
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef BLOCKCHAIN_RETARGET_H
+#define BLOCKCHAIN_RETARGET_H
+
+#include "blockchain/block.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum RetargetMode {
+    NO_RETARGET,           // fixed hex-zero difficulty, blocks carry no target
+    WINDOW_RETARGET,       // scale by observed/expected time over the last window
+    EXPONENTIAL_RETARGET   // ASERT style: 2^(schedule drift / half life) from genesis
+};
+
+struct RetargetConfig {
+    RetargetMode mode;
+    int interval;            // adjust every N blocks
+    double block_time_ms;    // desired spacing between blocks
+    double half_life_ms;     // exponential only: drift that halves/doubles the target
+    double max_adjust;       // window only: largest factor per adjustment
+};
+
+const RetargetConfig NO_RETARGETING = {NO_RETARGET, 1, 0, 0, 0};
+
+// Throws std::invalid_argument unless interval >= 1 and block_time_ms > 0,
+// plus max_adjust >= 1 for the window policy and half_life_ms > 0 for the
+// exponential one. NO_RETARGET configs are not checked.
+void validate_retarget_config(const RetargetConfig& cfg);
+
+struct BlockTelemetry {
+    int height;
+    double solve_ms;
+    int attempts;
+    uint64_t target;
+    double difficulty;       // relative to MAX_TARGET
+    double hashrate;         // estimated network hashes per second
+};
+
+// Number of recent blocks the hashrate estimate averages over.
+const int HASHRATE_WINDOW = 10;
+
+// Timestamp rules. Retargeting trusts block timestamps, so a block must be
+// later than the median of the previous MEDIAN_TIME_SPAN blocks and at most
+// MAX_FUTURE_MS ahead of the validator's clock.
+const int MEDIAN_TIME_SPAN = 11;
+const int64_t MAX_FUTURE_MS = 2000;
+
+// Median timestamp of the up to MEDIAN_TIME_SPAN blocks below `height`.
+int64_t median_time_past(const std::vector<Block>& blocks, size_t height);
+
+// Rounds a scaled target into [1, MAX_TARGET].
+uint64_t clamp_target(double t);
+
+// The target a block at `height` must meet. It only depends on
+// blocks[0, height), so validators recompute it the same way.
+uint64_t target_for_height(const std::vector<Block>& blocks, size_t height,
+                           const RetargetConfig& cfg);
+
+#endif
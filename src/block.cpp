@@ -0,0 +1,101 @@
+#include "blockchain/block.h"
+
+#include <cctype>
+#include <chrono>
+#include <sstream>
+
+using namespace std;
+
+uint64_t difficulty_to_target(int difficulty) {
+    if (difficulty <= 0) {
+        return MAX_TARGET;
+    }
+    if (difficulty >= 16) {
+        return 0;
+    }
+    return (1ULL << (64 - 4 * difficulty)) - 1;
+}
+
+bool is_hex_hash(const string& hash) {
+    if (hash.size() != 64) {
+        return false;
+    }
+    for (char c : hash) {
+        if (!isxdigit((unsigned char)c)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t hash_value(const string& hash) {
+    return stoull(hash.substr(0, 16), nullptr, 16);
+}
+
+double expected_hashes(uint64_t target) {
+    return 18446744073709551616.0 / ((double)target + 1.0);
+}
+
+int64_t now_ms() {
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+Block::Block(int idx, string d, string prev_hash) {
+    index = idx;
+    data = d;
+    previous_hash = prev_hash;
+    timestamp = now_ms();
+    target = 0;
+    nonce = 0;
+    hash = "";
+}
+
+string Block::calculate_hash(HashMode mode) const {
+    stringstream ss;
+    ss << index << data << previous_hash << timestamp;
+    if (target != 0) {
+        ss << target;
+    }
+    ss << nonce;
+    
+    if (mode == SHA256_MODE) {
+        return sha256_hash(ss.str());
+    } else {
+        return ac_hash(ss.str(), 30, 100);
+    }
+}
+
+bool Block::has_valid_proof(int difficulty) const {
+    if (!is_hex_hash(hash)) {
+        return false;
+    }
+    if (target != 0) {
+        return hash_value(hash) <= target;
+    }
+    return meets_target(hash, difficulty);
+}
+
+int Block::mine_block(int difficulty, HashMode mode) {
+    int iterations = 0;
+    
+    do {
+        nonce++;
+        iterations++;
+        hash = calculate_hash(mode);
+    } while (!has_valid_proof(difficulty));
+    
+    return iterations;
+}
+
+bool meets_target(const string& hash, int difficulty) {
+    if ((int)hash.size() < difficulty) {
+        return false;
+    }
+    for (int i = 0; i < difficulty; i++) {
+        if (hash[i] != '0') {
+            return false;
+        }
+    }
+    return true;
+}
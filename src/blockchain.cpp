@@ -0,0 +1,255 @@
+#include "blockchain/blockchain.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+Blockchain::Blockchain(int diff, HashMode mode, RetargetConfig cfg)
+    : background_state(BACKGROUND_IDLE), background_failed_at(0) {
+    validate_retarget_config(cfg);
+    difficulty = diff;
+    hash_mode = mode;
+    retarget = cfg;
+    trusted_height = 0;
+    chain.push_back(create_genesis_block());
+}
+
+Blockchain::~Blockchain() {
+    if (background.joinable()) {
+        background.join();
+    }
+}
+
+Block Blockchain::create_genesis_block() {
+    Block genesis(0, "Genesis Block", "0");
+    if (retarget.mode != NO_RETARGET) {
+        genesis.target = difficulty_to_target(difficulty);
+    }
+    genesis.hash = genesis.calculate_hash(hash_mode);
+    return genesis;
+}
+
+Block Blockchain::get_last_block() const {
+    return chain.back();
+}
+
+const vector<Block>& Blockchain::get_blocks() const {
+    return chain;
+}
+
+size_t Blockchain::size() const {
+    return chain.size();
+}
+
+uint64_t Blockchain::next_target() const {
+    return target_for_height(chain.size());
+}
+
+uint64_t Blockchain::target_for_height(size_t height) const {
+    return ::target_for_height(chain, height, retarget);
+}
+
+void Blockchain::prepare_block(Block& block) const {
+    block.previous_hash = get_last_block().hash;
+    block.target = next_target();
+    block.timestamp = max(block.timestamp, median_time_past(chain, chain.size()) + 1);
+}
+
+int Blockchain::add_block(Block new_block) {
+    prepare_block(new_block);
+
+    auto start = chrono::steady_clock::now();
+    int iterations = new_block.mine_block(difficulty, hash_mode);
+    auto elapsed = chrono::steady_clock::now() - start;
+
+    chain.push_back(new_block);
+    record_telemetry(new_block, chrono::duration_cast<chrono::microseconds>(elapsed).count() / 1000.0,
+                     iterations);
+    return iterations;
+}
+
+void Blockchain::add_mined_block(const Block& block, int attempts) {
+    chain.push_back(block);
+    record_telemetry(block, max<int64_t>(0, now_ms() - block.timestamp), attempts);
+}
+
+// Blocks without a target are rated at their fixed difficulty.
+static uint64_t effective_target(uint64_t target, int difficulty) {
+    return max<uint64_t>(1, target != 0 ? target : difficulty_to_target(difficulty));
+}
+
+void Blockchain::record_telemetry(const Block& block, double solve_ms, int attempts) {
+    uint64_t target = effective_target(block.target, difficulty);
+    BlockTelemetry t = {block.index, solve_ms, attempts, target, (double)MAX_TARGET / target, 0};
+    telemetry.push_back(t);
+    telemetry.back().hashrate = estimate_hashrate();
+    for (auto& callback : subscribers) {
+        callback(telemetry.back());
+    }
+}
+
+// Expected work over the last few blocks divided by the time it took.
+double Blockchain::estimate_hashrate() const {
+    size_t n = min((size_t)HASHRATE_WINDOW, telemetry.size());
+    double work = 0;
+    double secs = 0;
+    for (size_t i = telemetry.size() - n; i < telemetry.size(); i++) {
+        work += expected_hashes(telemetry[i].target);
+        secs += telemetry[i].solve_ms / 1000.0;
+    }
+    return secs > 0 ? work / secs : 0;
+}
+
+void Blockchain::subscribe(function<void(const BlockTelemetry&)> callback) {
+    subscribers.push_back(callback);
+}
+
+const vector<BlockTelemetry>& Blockchain::get_telemetry() const {
+    return telemetry;
+}
+
+bool Blockchain::check_link(const vector<Block>& blocks, size_t i) const {
+    const Block& current = blocks[i];
+    const Block& previous = blocks[i - 1];
+    return current.index == (int)i &&
+           current.previous_hash == previous.hash &&
+           current.timestamp > median_time_past(blocks, i) &&
+           current.timestamp <= now_ms() + MAX_FUTURE_MS &&
+           current.target == ::target_for_height(blocks, i, retarget) &&
+           current.has_valid_proof(difficulty);
+}
+
+bool Blockchain::is_chain_valid() const {
+    for (size_t i = 1; i < chain.size(); i++) {
+        if (chain[i].hash != chain[i].calculate_hash(hash_mode)) {
+            return false;
+        }
+        if (!check_link(chain, i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Blockchain::print_chain() const {
+    for (const Block& block : chain) {
+        cout << "Block #" << block.index << endl;
+        cout << "Data: " << block.data << endl;
+        cout << "Hash: " << block.hash << endl;
+        cout << "Previous Hash: " << block.previous_hash << endl;
+        cout << "Nonce: " << block.nonce << endl << endl;
+    }
+}
+
+Snapshot Blockchain::create_snapshot(uint32_t interval) const {
+    Snapshot snap;
+    snap.mode = hash_mode;
+    snap.difficulty = difficulty;
+    snap.interval = interval;
+    snap.tip = chain.back();
+    for (size_t h = interval; h < chain.size(); h += interval) {
+        snap.checkpoints.push_back({(uint32_t)h, chain[h].hash});
+    }
+    return snap;
+}
+
+bool Blockchain::fast_sync(const vector<Block>& blocks, const Snapshot& snap) {
+    size_t tip = snap.tip.index;
+    if (snap.mode != hash_mode || snap.difficulty != difficulty ||
+        blocks.empty() || blocks.size() <= tip || blocks[0].index != 0 ||
+        blocks[0].target != chain[0].target) {
+        return false;
+    }
+
+    const Block& local_tip = blocks[tip];
+    if (local_tip.hash != snap.tip.hash || local_tip.data != snap.tip.data ||
+        local_tip.previous_hash != snap.tip.previous_hash ||
+        local_tip.timestamp != snap.tip.timestamp || local_tip.target != snap.tip.target ||
+        local_tip.nonce != snap.tip.nonce) {
+        return false;
+    }
+
+    for (const Checkpoint& cp : snap.checkpoints) {
+        if (cp.height > tip || blocks[cp.height].hash != cp.hash) {
+            return false;
+        }
+    }
+
+    for (size_t i = 1; i <= tip; i++) {
+        if (!check_link(blocks, i)) {
+            return false;
+        }
+    }
+
+    for (size_t i = tip + 1; i < blocks.size(); i++) {
+        if (blocks[i].hash != blocks[i].calculate_hash(hash_mode) || !check_link(blocks, i)) {
+            return false;
+        }
+    }
+
+    // Only adopt the blocks once every check has passed.
+    chain = blocks;
+    trusted_height = tip;
+    return true;
+}
+
+void Blockchain::background_validate(vector<Block> prefix) {
+#ifdef __linux__
+    setpriority(PRIO_PROCESS, syscall(SYS_gettid), 19);
+#endif
+    for (size_t i = 0; i < prefix.size(); i++) {
+        if (prefix[i].hash != prefix[i].calculate_hash(hash_mode)) {
+            background_failed_at = i;
+            background_state = BACKGROUND_FAILED;
+            return;
+        }
+    }
+    background_state = BACKGROUND_CONFIRMED;
+}
+
+void Blockchain::start_background_validation() {
+    if (background.joinable()) {
+        background.join();
+    }
+    background_state = BACKGROUND_RUNNING;
+    vector<Block> prefix(chain.begin(), chain.begin() + trusted_height + 1);
+    background = thread(&Blockchain::background_validate, this, prefix);
+}
+
+bool Blockchain::wait_background_validation() {
+    if (background.joinable()) {
+        background.join();
+    }
+    if (background_state == BACKGROUND_CONFIRMED) {
+        trusted_height = 0;
+        return true;
+    }
+    if (background_state == BACKGROUND_FAILED) {
+        // Everything below the bad block was rehashed and is kept; the bad
+        // block and anything built on it are dropped.
+        size_t keep = background_failed_at;
+        if (keep == 0) {
+            chain.assign(1, create_genesis_block());
+        } else {
+            chain.erase(chain.begin() + keep, chain.end());
+        }
+        trusted_height = 0;
+    }
+    return false;
+}
+
+size_t Blockchain::get_trusted_height() const {
+    return trusted_height;
+}
+
+size_t Blockchain::get_background_failed_at() const {
+    return background_failed_at;
+}
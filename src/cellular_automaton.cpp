@@ -0,0 +1,37 @@
+#include "blockchain/cellular_automaton.h"
+
+#include <iostream>
+
+using namespace std;
+
+CellularAutomaton::CellularAutomaton(int r) : rule(r) {}
+
+void CellularAutomaton::init_state(const vector<int>& initial) {
+    state = initial;
+}
+
+void CellularAutomaton::evolve() {
+    int n = state.size();
+    vector<int> new_state(n);
+    
+    for (int i = 0; i < n; i++) {
+        int left = (i == 0) ? 0 : state[i - 1];
+        int center = state[i];
+        int right = (i == n - 1) ? 0 : state[i + 1];
+        
+        new_state[i] = get_next_cell(left, center, right);
+    }
+    
+    state = new_state;
+}
+
+void CellularAutomaton::print() const {
+    for (int cell : state) {
+        cout << (cell ? "█" : " ");
+    }
+    cout << endl;
+}
+
+vector<int> CellularAutomaton::get_state() const {
+    return state;
+}
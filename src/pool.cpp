@@ -0,0 +1,225 @@
+#include "blockchain/pool.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+void MessageWriter::u8(uint8_t v) {
+    bytes.push_back(v);
+}
+
+void MessageWriter::u32(uint32_t v) {
+    for (int i = 3; i >= 0; i--) {
+        bytes.push_back((v >> (i * 8)) & 0xff);
+    }
+}
+
+void MessageWriter::i64(int64_t v) {
+    uint64_t u = (uint64_t)v;
+    for (int i = 7; i >= 0; i--) {
+        bytes.push_back((u >> (i * 8)) & 0xff);
+    }
+}
+
+void MessageWriter::str(const string& s) {
+    uint16_t len = (uint16_t)min(s.size(), (size_t)0xffff);
+    bytes.push_back(len >> 8);
+    bytes.push_back(len & 0xff);
+    bytes.insert(bytes.end(), s.begin(), s.begin() + len);
+}
+
+void MessageWriter::hash(const string& hex_hash) {
+    for (size_t i = 0; i + 1 < hex_hash.size() && i < 64; i += 2) {
+        bytes.push_back((uint8_t)stoul(hex_hash.substr(i, 2), nullptr, 16));
+    }
+}
+
+void MessageReader::need(size_t n) {
+    if (pos + n > bytes.size()) {
+        throw runtime_error("truncated message");
+    }
+}
+
+uint8_t MessageReader::u8() {
+    need(1);
+    return bytes[pos++];
+}
+
+uint32_t MessageReader::u32() {
+    need(4);
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++) {
+        v = (v << 8) | bytes[pos++];
+    }
+    return v;
+}
+
+int64_t MessageReader::i64() {
+    need(8);
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) {
+        v = (v << 8) | bytes[pos++];
+    }
+    return (int64_t)v;
+}
+
+string MessageReader::str() {
+    need(2);
+    size_t len = (bytes[pos] << 8) | bytes[pos + 1];
+    pos += 2;
+    need(len);
+    string s(bytes.begin() + pos, bytes.begin() + pos + len);
+    pos += len;
+    return s;
+}
+
+string MessageReader::hash() {
+    need(32);
+    stringstream ss;
+    for (int i = 0; i < 32; i++) {
+        ss << hex << setw(2) << setfill('0') << (int)bytes[pos++];
+    }
+    return ss.str();
+}
+
+vector<uint8_t> encode_frame(uint8_t type, const MessageWriter& w) {
+    vector<uint8_t> frame;
+    frame.reserve(HEADER_SIZE + w.bytes.size());
+    frame.push_back(type);
+    uint32_t len = w.bytes.size();
+    for (int i = 3; i >= 0; i--) {
+        frame.push_back((len >> (i * 8)) & 0xff);
+    }
+    frame.insert(frame.end(), w.bytes.begin(), w.bytes.end());
+    return frame;
+}
+
+uint32_t frame_length(const uint8_t* header) {
+    return ((uint32_t)header[1] << 24) | ((uint32_t)header[2] << 16) |
+           ((uint32_t)header[3] << 8) | header[4];
+}
+
+int decode_frame(vector<uint8_t>& buf, Message& msg) {
+    if (buf.size() < HEADER_SIZE) {
+        return 0;
+    }
+    uint32_t len = frame_length(buf.data());
+    if (len > MAX_PAYLOAD) {
+        return -1;
+    }
+    if (buf.size() < HEADER_SIZE + len) {
+        return 0;
+    }
+    msg.type = buf[0];
+    msg.payload.assign(buf.begin() + HEADER_SIZE, buf.begin() + HEADER_SIZE + len);
+    buf.erase(buf.begin(), buf.begin() + HEADER_SIZE + len);
+    return 1;
+}
+
+MessageWriter encode_job(const Job& job) {
+    MessageWriter msg;
+    msg.u32(job.id);
+    msg.u32(job.block.index);
+    msg.i64(job.block.timestamp);
+    msg.i64((int64_t)job.block.target);
+    msg.u8(job.difficulty);
+    msg.u8(job.share_difficulty);
+    msg.u8(job.mode);
+    msg.u32(job.nonce_start);
+    msg.u32(job.nonce_count);
+    msg.hash(job.block.previous_hash);
+    msg.str(job.block.data);
+    return msg;
+}
+
+Job parse_job(const Message& msg) {
+    MessageReader in(msg.payload);
+    uint32_t id = in.u32();
+    int index = in.u32();
+    int64_t timestamp = in.i64();
+    uint64_t target = (uint64_t)in.i64();
+    int difficulty = in.u8();
+    int share_difficulty = in.u8();
+    HashMode mode = (HashMode)in.u8();
+    uint32_t start = in.u32();
+    uint32_t count = in.u32();
+    string prev_hash = in.hash();
+    string data = in.str();
+
+    Block block(index, data, prev_hash);
+    block.timestamp = timestamp;
+    block.target = target;
+    return {id, block, difficulty, share_difficulty, mode, start, count};
+}
+
+bool owns_nonce(const NonceRanges& ranges, uint32_t nonce) {
+    for (const auto& range : ranges) {
+        if (nonce >= range.first && nonce - range.first < range.second) {
+            return true;
+        }
+    }
+    return false;
+}
+
+ShareValidator::ShareValidator(int diff, int share_diff, HashMode mode)
+    : difficulty(diff), share_difficulty(share_diff), hash_mode(mode),
+      current(0, "", ""), job_id(0), next_nonce(1), closed(false) {}
+
+void ShareValidator::new_job(const Block& block) {
+    current = block;
+    job_id++;
+    next_nonce = 1;
+    seen_nonces.clear();
+}
+
+void ShareValidator::close() {
+    closed = true;
+}
+
+bool ShareValidator::is_closed() const {
+    return closed;
+}
+
+uint32_t ShareValidator::get_job_id() const {
+    return job_id;
+}
+
+const Block& ShareValidator::get_template() const {
+    return current;
+}
+
+Job ShareValidator::assign_range(NonceRanges& ranges, uint32_t count) {
+    uint32_t start = next_nonce;
+    next_nonce += count;
+    ranges.push_back({start, count});
+    return {job_id, current, difficulty, share_difficulty, hash_mode, start, count};
+}
+
+ShareStatus ShareValidator::check_share(const NonceRanges& ranges, uint32_t job, uint32_t nonce,
+                                        Block& candidate) {
+    if (closed || job != job_id) {
+        return SHARE_STALE;
+    }
+    // Only credit work from the ranges this worker was assigned.
+    if (!owns_nonce(ranges, nonce)) {
+        return SHARE_INVALID;
+    }
+    if (!seen_nonces.insert(nonce).second) {
+        return SHARE_DUPLICATE;
+    }
+
+    candidate = current;
+    candidate.nonce = (int)nonce;
+    candidate.hash = candidate.calculate_hash(hash_mode);
+
+    if (!meets_target(candidate.hash, share_difficulty)) {
+        return SHARE_INVALID;
+    }
+    if (!candidate.has_valid_proof(difficulty)) {
+        return SHARE_ACCEPTED;
+    }
+    return SHARE_BLOCK;
+}
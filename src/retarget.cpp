@@ -0,0 +1,70 @@
+#include "blockchain/retarget.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+void validate_retarget_config(const RetargetConfig& cfg) {
+    if (cfg.mode == NO_RETARGET) {
+        return;
+    }
+    if (cfg.interval < 1) {
+        throw invalid_argument("retarget interval must be at least 1");
+    }
+    if (!(cfg.block_time_ms > 0)) {
+        throw invalid_argument("retarget block_time_ms must be positive");
+    }
+    if (cfg.mode == WINDOW_RETARGET && !(cfg.max_adjust >= 1)) {
+        throw invalid_argument("window retarget max_adjust must be at least 1");
+    }
+    if (cfg.mode == EXPONENTIAL_RETARGET && !(cfg.half_life_ms > 0)) {
+        throw invalid_argument("exponential retarget half_life_ms must be positive");
+    }
+}
+
+int64_t median_time_past(const vector<Block>& blocks, size_t height) {
+    size_t first = height > (size_t)MEDIAN_TIME_SPAN ? height - MEDIAN_TIME_SPAN : 0;
+    vector<int64_t> times;
+    for (size_t i = first; i < height; i++) {
+        times.push_back(blocks[i].timestamp);
+    }
+    nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+    return times[times.size() / 2];
+}
+
+uint64_t clamp_target(double t) {
+    if (t < 1.0) {
+        return 1;
+    }
+    if (t >= (double)MAX_TARGET) {
+        return MAX_TARGET;
+    }
+    return (uint64_t)t;
+}
+
+uint64_t target_for_height(const vector<Block>& blocks, size_t height, const RetargetConfig& cfg) {
+    const Block& parent = blocks[height - 1];
+    if (cfg.mode == NO_RETARGET || height % cfg.interval != 0) {
+        return parent.target;
+    }
+
+    if (cfg.mode == WINDOW_RETARGET) {
+        if (height <= (size_t)cfg.interval) {
+            return parent.target;
+        }
+        const Block& first = blocks[height - 1 - cfg.interval];
+        double actual = max<double>(1, parent.timestamp - first.timestamp);
+        double expected = cfg.interval * cfg.block_time_ms;
+        double factor = actual / expected;
+        factor = max(1.0 / cfg.max_adjust, min(cfg.max_adjust, factor));
+        return clamp_target(parent.target * factor);
+    }
+
+    const Block& anchor = blocks[0];
+    double elapsed = parent.timestamp - anchor.timestamp;
+    double ideal = (height - 1) * cfg.block_time_ms;
+    double exponent = (elapsed - ideal) / cfg.half_life_ms;
+    return clamp_target(anchor.target * pow(2.0, exponent));
+}
@@ -0,0 +1,256 @@
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "blockchain/blockchain.h"
+#include "test_common.h"
+
+using namespace std;
+
+void test_mine_block() {
+    Block block(1, "Transaction 1", string(64, '0'));
+    int iterations = block.mine_block(2, SHA256_MODE);
+    CHECK(iterations == block.nonce);
+    CHECK(meets_target(block.hash, 2));
+    CHECK(block.hash == block.calculate_hash(SHA256_MODE));
+}
+
+void test_meets_target() {
+    CHECK(meets_target("00ab", 2));
+    CHECK(!meets_target("0a0b", 2));
+    CHECK(meets_target("abcd", 0));
+    CHECK(!meets_target("0", 2));
+}
+
+void test_numeric_target() {
+    CHECK(difficulty_to_target(2) == 0x00ffffffffffffffULL);
+    CHECK(hash_value("00ff000000000000abcd") == 0x00ff000000000000ULL);
+    CHECK(is_hex_hash(string(63, '0') + "f"));
+    CHECK(!is_hex_hash(string(63, '0') + "z"));
+    CHECK(!is_hex_hash("00ff"));
+
+    Block block(1, "Transaction 1", "0");
+    block.target = difficulty_to_target(2) / 3;
+    block.mine_block(0, SHA256_MODE);
+    CHECK(hash_value(block.hash) <= block.target);
+    CHECK(block.has_valid_proof(0));
+
+    // The target is hashed, so changing it invalidates the proof.
+    Block copy = block;
+    copy.target = block.target + 1;
+    CHECK(copy.calculate_hash(SHA256_MODE) != block.hash);
+}
+
+void test_chain_validation() {
+    Blockchain chain(2, SHA256_MODE);
+    for (int i = 1; i <= 5; i++) {
+        chain.add_block(Block(i, "Transaction " + to_string(i), ""));
+    }
+    CHECK(chain.size() == 6);
+    CHECK(chain.is_chain_valid());
+
+    // A block whose hash does not match its contents is rejected even if the
+    // hash itself meets the target and links correctly.
+    Block forged(6, "Forged", chain.get_last_block().hash);
+    forged.hash = string(64, '0');
+    chain.add_mined_block(forged);
+    CHECK(!chain.is_chain_valid());
+}
+
+// Blocks spaced `spacing_ms` apart, all at `target`.
+vector<Block> spaced_blocks(size_t count, int64_t spacing_ms, uint64_t target) {
+    vector<Block> blocks;
+    for (size_t i = 0; i < count; i++) {
+        Block block(i, "Transaction " + to_string(i), "");
+        block.timestamp = i * spacing_ms;
+        block.target = target;
+        blocks.push_back(block);
+    }
+    return blocks;
+}
+
+void test_window_retarget() {
+    RetargetConfig cfg = {WINDOW_RETARGET, 4, 100, 0, 4.0};
+    uint64_t target = 1ULL << 40;
+
+    // Between adjustments and during the first window the target is kept.
+    CHECK(target_for_height(spaced_blocks(8, 1000, target), 7, cfg) == target);
+    CHECK(target_for_height(spaced_blocks(8, 1000, target), 4, cfg) == target);
+
+    // On schedule the target stays put.
+    CHECK(target_for_height(spaced_blocks(8, 100, target), 8, cfg) == target);
+
+    // Blocks 10x too slow or 100x too fast move it by at most max_adjust.
+    CHECK(target_for_height(spaced_blocks(8, 1000, target), 8, cfg) == target * 4);
+    CHECK(target_for_height(spaced_blocks(8, 1, target), 8, cfg) == target / 4);
+}
+
+void test_exponential_retarget() {
+    RetargetConfig cfg = {EXPONENTIAL_RETARGET, 1, 100, 400, 0};
+    uint64_t target = 1ULL << 40;
+    vector<Block> blocks = spaced_blocks(5, 100, target);
+    CHECK(target_for_height(blocks, 5, cfg) == target);
+
+    // One half life behind schedule doubles the target, one ahead halves it.
+    blocks[4].timestamp += 400;
+    CHECK(target_for_height(blocks, 5, cfg) == target * 2);
+    blocks[4].timestamp -= 800;
+    CHECK(target_for_height(blocks, 5, cfg) == target / 2);
+}
+
+// True when constructing a chain with `cfg` throws std::invalid_argument.
+bool rejects_config(RetargetConfig cfg) {
+    try {
+        Blockchain chain(2, SHA256_MODE, cfg);
+    } catch (const invalid_argument&) {
+        return true;
+    }
+    return false;
+}
+
+void test_retarget_config() {
+    CHECK(!rejects_config(NO_RETARGETING));
+    CHECK(!rejects_config({WINDOW_RETARGET, 4, 100, 0, 4.0}));
+    CHECK(!rejects_config({EXPONENTIAL_RETARGET, 1, 100, 400, 0}));
+    CHECK(rejects_config({WINDOW_RETARGET, 0, 100, 0, 4.0}));
+    CHECK(rejects_config({WINDOW_RETARGET, 4, 0, 0, 4.0}));
+    CHECK(rejects_config({WINDOW_RETARGET, 4, 100, 0, 0}));
+    CHECK(rejects_config({EXPONENTIAL_RETARGET, 1, 100, 0, 0}));
+    CHECK(rejects_config({EXPONENTIAL_RETARGET, 1, -100, 400, 0}));
+}
+
+void test_retarget_validation() {
+    RetargetConfig cfg = {WINDOW_RETARGET, 2, 1, 0, 4.0};
+    Blockchain chain(2, SHA256_MODE, cfg);
+    int published = 0;
+    chain.subscribe([&](const BlockTelemetry&) { published++; });
+    for (int i = 1; i <= 6; i++) {
+        chain.add_block(Block(i, "Transaction " + to_string(i), ""));
+    }
+    CHECK(chain.get_blocks()[0].target == difficulty_to_target(2));
+    CHECK(published == 6);
+    CHECK(chain.get_telemetry().size() == 6);
+    CHECK(chain.is_chain_valid());
+
+    // A correctly mined block that claims an easier target is rejected.
+    Block easy(7, "Easy", "");
+    chain.prepare_block(easy);
+    easy.target *= 2;
+    easy.mine_block(2, SHA256_MODE);
+    chain.add_mined_block(easy);
+    CHECK(!chain.is_chain_valid());
+}
+
+// Mines a block on `chain` with its timestamp replaced by `timestamp`.
+Block block_at(const Blockchain& chain, int64_t timestamp) {
+    Block block(chain.size(), "Transaction", "");
+    chain.prepare_block(block);
+    block.timestamp = timestamp;
+    block.mine_block(2, SHA256_MODE);
+    return block;
+}
+
+void test_timestamp_rules() {
+    RetargetConfig cfg = {EXPONENTIAL_RETARGET, 1, 100, 400, 0};
+
+    // A block far in the future would make every later block free.
+    Blockchain future(2, SHA256_MODE, cfg);
+    future.add_block(Block(1, "Transaction 1", ""));
+    future.add_mined_block(block_at(future, future.get_last_block().timestamp + 100000000));
+    CHECK(!future.is_chain_valid());
+
+    // A block at or before the median of its parents is rejected too.
+    Blockchain backwards(2, SHA256_MODE, cfg);
+    backwards.add_block(Block(1, "Transaction 1", ""));
+    backwards.add_block(Block(2, "Transaction 2", ""));
+    backwards.add_mined_block(block_at(backwards, backwards.get_blocks()[0].timestamp - 1));
+    CHECK(!backwards.is_chain_valid());
+
+    // Blocks mined within the same millisecond still get valid timestamps.
+    Blockchain fast(2, SHA256_MODE, cfg);
+    for (int i = 1; i <= 15; i++) {
+        fast.add_block(Block(i, "Transaction " + to_string(i), ""));
+    }
+    CHECK(fast.is_chain_valid());
+}
+
+void test_fast_sync() {
+    Blockchain full(1, SHA256_MODE);
+    for (int i = 1; i <= 15; i++) {
+        full.add_block(Block(i, "Transaction " + to_string(i), ""));
+    }
+    Snapshot snap = full.create_snapshot(5);
+    CHECK(snap.tip.index == 15);
+    CHECK(snap.checkpoints.size() == 3);
+    for (int i = 16; i <= 20; i++) {
+        full.add_block(Block(i, "Transaction " + to_string(i), ""));
+    }
+
+    Blockchain node(1, SHA256_MODE);
+    CHECK(node.fast_sync(full.get_blocks(), snap));
+    CHECK(node.get_trusted_height() == 15);
+    node.start_background_validation();
+    CHECK(node.wait_background_validation());
+    CHECK(node.get_trusted_height() == 0);
+
+    // A rewritten block below the checkpoint passes the linkage check but
+    // is caught by background validation.
+    vector<Block> blocks = full.get_blocks();
+    blocks[3].data = "Rewritten";
+    Blockchain tampered(1, SHA256_MODE);
+    CHECK(tampered.fast_sync(blocks, snap));
+    tampered.start_background_validation();
+    CHECK(!tampered.wait_background_validation());
+    CHECK(tampered.get_background_failed_at() == 3);
+
+    // The forged block and everything after it are dropped, and new blocks
+    // extend the verified part.
+    CHECK(tampered.size() == 3);
+    CHECK(tampered.get_trusted_height() == 0);
+    CHECK(tampered.is_chain_valid());
+    tampered.add_block(Block(3, "Transaction 3", ""));
+    CHECK(tampered.size() == 4);
+    CHECK(tampered.is_chain_valid());
+
+    // Blocks after the checkpoint are always fully validated.
+    blocks = full.get_blocks();
+    blocks[18].data = "Rewritten";
+    Blockchain late(1, SHA256_MODE);
+    CHECK(!late.fast_sync(blocks, snap));
+    CHECK(late.size() == 1);
+    CHECK(late.get_trusted_height() == 0);
+
+    // A malformed hash in the trusted prefix is rejected, not parsed.
+    RetargetConfig cfg = {WINDOW_RETARGET, 2, 1, 0, 4.0};
+    Blockchain retargeting(1, SHA256_MODE, cfg);
+    for (int i = 1; i <= 6; i++) {
+        retargeting.add_block(Block(i, "Transaction " + to_string(i), ""));
+    }
+    Snapshot retarget_snap = retargeting.create_snapshot(5);
+    blocks = retargeting.get_blocks();
+    blocks[3].hash = string(64, 'z');
+    blocks[4].previous_hash = blocks[3].hash;
+    Blockchain malformed(1, SHA256_MODE, cfg);
+    CHECK(!malformed.fast_sync(blocks, retarget_snap));
+    CHECK(malformed.size() == 1);
+
+    // Committed hashes must match.
+    Snapshot wrong = snap;
+    wrong.checkpoints[1].hash = string(64, '0');
+    Blockchain mismatched(1, SHA256_MODE);
+    CHECK(!mismatched.fast_sync(full.get_blocks(), wrong));
+}
+
+int main() {
+    test_mine_block();
+    test_meets_target();
+    test_numeric_target();
+    test_chain_validation();
+    test_window_retarget();
+    test_exponential_retarget();
+    test_retarget_config();
+    test_retarget_validation();
+    test_timestamp_rules();
+    test_fast_sync();
+    return failures != 0;
+}
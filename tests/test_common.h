@@ -0,0 +1,19 @@
+#ifndef BLOCKCHAIN_TEST_COMMON_H
+#define BLOCKCHAIN_TEST_COMMON_H
+
+#include <iostream>
+
+// Minimal check macro: reports the failing expression and keeps going, so
+// one run lists every failure. Test mains return `failures != 0`.
+static int failures = 0;
+
+#define CHECK(expr)                                                          \
+    do {                                                                     \
+        if (!(expr)) {                                                       \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: "   \
+                      << #expr << std::endl;                                 \
+            failures++;                                                      \
+        }                                                                    \
+    } while (0)
+
+#endif
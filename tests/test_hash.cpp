@@ -0,0 +1,53 @@
+#include <string>
+#include <vector>
+
+#include "blockchain/cellular_automaton.h"
+#include "blockchain/hash.h"
+#include "test_common.h"
+
+using namespace std;
+
+void test_rule_90() {
+    CellularAutomaton ca(90);
+    ca.init_state({0, 0, 1, 0, 0});
+    ca.evolve();
+    CHECK((ca.get_state() == vector<int>{0, 1, 0, 1, 0}));
+    ca.evolve();
+    CHECK((ca.get_state() == vector<int>{1, 0, 0, 0, 1}));
+}
+
+void test_rule_30() {
+    CellularAutomaton ca(30);
+    ca.init_state({0, 0, 0, 1, 0, 0, 0});
+    ca.evolve();
+    CHECK((ca.get_state() == vector<int>{0, 0, 1, 1, 1, 0, 0}));
+    ca.evolve();
+    CHECK((ca.get_state() == vector<int>{0, 1, 1, 0, 0, 1, 0}));
+}
+
+void test_sha256_vectors() {
+    CHECK(sha256_hash("") == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    CHECK(sha256_hash("abc") == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    CHECK(sha256_hash("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq") ==
+          "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    CHECK(sha256_hash(string(1000, 'a')) ==
+          "41edece42d63e8d9bf515a9ba6932e1c20cbc9f5a5d134645adb5db1b9737ea3");
+    CHECK(sha256_digest("abc").size() == 32);
+}
+
+void test_ac_hash() {
+    string h1 = ac_hash("Hello, World!", 30, 100);
+    string h2 = ac_hash("Hello, World?", 30, 100);
+    CHECK(h1.size() == 64);
+    CHECK(h1 == ac_hash("Hello, World!", 30, 100));
+    CHECK(h1 != h2);
+    CHECK(ac_hash(string(200, 'x'), 30, 100).size() == 64);
+}
+
+int main() {
+    test_rule_90();
+    test_rule_30();
+    test_sha256_vectors();
+    test_ac_hash();
+    return failures != 0;
+}
@@ -0,0 +1,166 @@
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "blockchain/pool.h"
+#include "test_common.h"
+
+using namespace std;
+
+// True when reading the whole payload as `n` u32 fields throws.
+bool truncated(const vector<uint8_t>& payload, int n) {
+    MessageReader in(payload);
+    try {
+        for (int i = 0; i < n; i++) {
+            in.u32();
+        }
+    } catch (const runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+void test_message_fields() {
+    MessageWriter w;
+    w.u8(7);
+    w.u32(0xdeadbeef);
+    w.i64(-5);
+    w.str("worker-1");
+    w.hash(string(62, '0') + "ff");
+
+    MessageReader in(w.bytes);
+    CHECK(in.u8() == 7);
+    CHECK(in.u32() == 0xdeadbeef);
+    CHECK(in.i64() == -5);
+    CHECK(in.str() == "worker-1");
+    CHECK(in.hash() == string(62, '0') + "ff");
+
+    // Reading past the end throws instead of reading garbage.
+    CHECK(truncated(vector<uint8_t>{1, 2, 3}, 1));
+    CHECK(!truncated(vector<uint8_t>{1, 2, 3, 4}, 1));
+    CHECK(truncated(vector<uint8_t>{1, 2, 3, 4}, 2));
+}
+
+void test_frames() {
+    MessageWriter w;
+    w.u32(42);
+    vector<uint8_t> frame = encode_frame(MSG_SHARE, w);
+    CHECK(frame.size() == HEADER_SIZE + 4);
+    CHECK(frame_length(frame.data()) == 4);
+
+    // A partial frame waits for more bytes and leaves the buffer alone.
+    Message msg;
+    vector<uint8_t> buf(frame.begin(), frame.end() - 1);
+    CHECK(decode_frame(buf, msg) == 0);
+    CHECK(buf.size() == frame.size() - 1);
+
+    // Two frames in one read come out one at a time.
+    buf = frame;
+    buf.insert(buf.end(), frame.begin(), frame.end());
+    CHECK(decode_frame(buf, msg) == 1);
+    CHECK(msg.type == MSG_SHARE);
+    CHECK(MessageReader(msg.payload).u32() == 42);
+    CHECK(decode_frame(buf, msg) == 1);
+    CHECK(buf.empty());
+
+    // A header announcing more than MAX_PAYLOAD is rejected up front.
+    buf = {MSG_SHARE, 0x00, 0x01, 0x00, 0x01};
+    CHECK(decode_frame(buf, msg) == -1);
+}
+
+void test_job_round_trip() {
+    Block block(3, "Transaction 3", string(63, '0') + "a");
+    block.timestamp = 1234567;
+    block.target = 0x00ffffffffffffffULL;
+    Job job = {9, block, 4, 2, SHA256_MODE, 4097, 4096};
+
+    Message msg = {MSG_JOB, encode_job(job).bytes};
+    Job parsed = parse_job(msg);
+    CHECK(parsed.id == 9);
+    CHECK(parsed.difficulty == 4);
+    CHECK(parsed.share_difficulty == 2);
+    CHECK(parsed.nonce_start == 4097);
+    CHECK(parsed.nonce_count == 4096);
+    CHECK(parsed.block.calculate_hash(SHA256_MODE) == block.calculate_hash(SHA256_MODE));
+
+    msg.payload.pop_back();
+    bool threw = false;
+    try {
+        parse_job(msg);
+    } catch (const runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+void test_owns_nonce() {
+    NonceRanges ranges = {{1, 10}, {100, 5}};
+    CHECK(owns_nonce(ranges, 1));
+    CHECK(owns_nonce(ranges, 10));
+    CHECK(!owns_nonce(ranges, 11));
+    CHECK(owns_nonce(ranges, 104));
+    CHECK(!owns_nonce(ranges, 105));
+    CHECK(!owns_nonce(ranges, 0));
+}
+
+void test_share_validation() {
+    ShareValidator shares(2, 1, SHA256_MODE);
+    Block block(1, "Transaction 1", string(64, '0'));
+    block.timestamp = 1000;
+    shares.new_job(block);
+
+    NonceRanges mine;
+    NonceRanges theirs;
+    Job job = shares.assign_range(mine, 4096);
+    shares.assign_range(theirs, 4096);
+    CHECK(job.nonce_start == 1);
+    CHECK(theirs[0].first == 4097);
+
+    // Classify the nonces in our range by what they meet.
+    uint32_t weak = 0, share = 0, solution = 0;
+    for (uint32_t n = job.nonce_start; n < job.nonce_start + job.nonce_count; n++) {
+        Block b = block;
+        b.nonce = (int)n;
+        b.hash = b.calculate_hash(SHA256_MODE);
+        if (!meets_target(b.hash, 1)) {
+            weak = weak ? weak : n;
+        } else if (!meets_target(b.hash, 2)) {
+            share = share ? share : n;
+        } else {
+            solution = solution ? solution : n;
+        }
+    }
+    CHECK(weak && share && solution);
+
+    Block candidate(0, "", "");
+    uint32_t id = shares.get_job_id();
+    CHECK(shares.check_share(mine, id, weak, candidate) == SHARE_INVALID);
+    CHECK(shares.check_share(mine, id, share, candidate) == SHARE_ACCEPTED);
+    CHECK(candidate.nonce == (int)share);
+    CHECK(shares.check_share(mine, id, share, candidate) == SHARE_DUPLICATE);
+    CHECK(shares.check_share(mine, id, solution, candidate) == SHARE_BLOCK);
+    CHECK(candidate.hash == candidate.calculate_hash(SHA256_MODE));
+
+    // Another worker's range, or no range at all, is not ours to claim.
+    CHECK(shares.check_share(mine, id, theirs[0].first, candidate) == SHARE_INVALID);
+    CHECK(shares.check_share(mine, id, 0, candidate) == SHARE_INVALID);
+
+    // Shares for an old job, or after the final block, are stale.
+    CHECK(shares.check_share(mine, id + 1, share, candidate) == SHARE_STALE);
+    shares.new_job(block);
+    mine.clear();
+    shares.assign_range(mine, 4096);
+    CHECK(shares.check_share(mine, id, share, candidate) == SHARE_STALE);
+    CHECK(shares.check_share(mine, shares.get_job_id(), share, candidate) == SHARE_ACCEPTED);
+    shares.close();
+    CHECK(shares.check_share(mine, shares.get_job_id(), solution, candidate) == SHARE_STALE);
+}
+
+int main() {
+    test_message_fields();
+    test_frames();
+    test_job_round_trip();
+    test_owns_nonce();
+    test_share_validation();
+    return failures != 0;
+}